@@ -3,5 +3,15 @@
 // Set max buffer time to 2 seconds @ 48kHz
 #define MAX_BUFFER_SAMPLES static_cast<size_t>(48000 * 2.0f)
 
-// Max grains to play simultaneously
-#define MAX_GRAINS 8
\ No newline at end of file
+// Max grains to play simultaneously (one pool, panned into both outputs)
+#define MAX_GRAINS 8
+
+// Constant-power pan law resolution (entries from hard left to hard right)
+#define PAN_TABLE_SIZE 65
+
+// Preset scenes kept in QSPI flash
+#define NUM_SCENES 8
+#define SCENE_MAX_PARAMS 32
+
+// Longest scene morph (Morph = 100%)
+#define MAX_MORPH_SECONDS 8.0f
\ No newline at end of file
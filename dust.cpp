@@ -2,15 +2,19 @@
 #include "hw.h"
 #include "screen.h"
 #include "processing.h" 
+#include "scheduler.h"
 
 static Hardware   g_hw;
 static Screen     g_screen;
-static Processing g_proc;
+static Processing DUST_DTCM g_proc;
+static Scheduler  g_sched;
 
 void AudioCallback(AudioHandle::InputBuffer  in,
                    AudioHandle::OutputBuffer out,
                    size_t                    size)
 {
+    g_hw.CycleStart();
+
     // 1. Process Hardware
     g_hw.ProcessControls();
     
@@ -29,8 +33,15 @@ void AudioCallback(AudioHandle::InputBuffer  in,
         out[0][i] = outl;
         out[1][i] = outr;
     }
+    g_proc.EndBlock();
+
+    g_hw.CycleEnd();
 }
 
+// --- Background Tasks ---
+static void ScreenTask(void *ctx) { g_screen.DrawStatus(g_proc, g_hw); }
+static void StorageTask(void *ctx) { g_proc.presets.Step(g_hw.seed.qspi); }
+
 int main(void)
 {
     // Initialize
@@ -41,12 +52,12 @@ int main(void)
     // Start Audio
     g_hw.seed.StartAudio(AudioCallback);
 
+    // Register Tasks (priority 0 = most urgent)
+    g_sched.AddPeriodic("screen", ScreenTask, nullptr, 2, 33);
+    g_sched.AddPeriodic("storage", StorageTask, nullptr, 3, 10);
+
     while(1)
     {
-        // Update Screen
-        g_screen.DrawStatus(g_proc, g_hw);
-        
-        // Throttling
-        System::Delay(33);
+        g_sched.Poll();
     }
 }
\ No newline at end of file
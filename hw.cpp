@@ -4,9 +4,30 @@
 float DSY_SDRAM_BSS Hardware::buffer_a[LOOPER_MAX_SAMPLES];
 float DSY_SDRAM_BSS Hardware::buffer_b[LOOPER_MAX_SAMPLES];
 
+#ifdef DUST_USE_TCM
+extern uint32_t _sidust_itcm, _sdust_itcm, _edust_itcm;
+extern uint32_t _sidust_dtcm_data, _sdust_dtcm_data, _edust_dtcm_data;
+extern uint32_t _sdust_dtcm, _edust_dtcm;
+
+// Runs ahead of the other static constructors, so DTCM objects hold their
+// initial values before their constructors and ITCM code is in place
+// before main().
+static void __attribute__((constructor(101))) InitTcm()
+{
+    uint32_t *src = &_sidust_itcm;
+    for (uint32_t *dst = &_sdust_itcm; dst < &_edust_itcm;) *dst++ = *src++;
+    src = &_sidust_dtcm_data;
+    for (uint32_t *dst = &_sdust_dtcm_data; dst < &_edust_dtcm_data;) *dst++ = *src++;
+    for (uint32_t *dst = &_sdust_dtcm; dst < &_edust_dtcm;) *dst++ = 0;
+    __DSB();
+    __ISB();
+}
+#endif
+
 void Hardware::Init()
 {
     seed.Init();
+    ConfigureSdramMpu();
     seed.SetAudioBlockSize(4);
     sample_rate = seed.AudioSampleRate();
 
@@ -16,6 +37,34 @@ void Hardware::Init()
 
     // --- Button 1 (Looper) ---
     button1.Init(seed.GetPin(1), seed.AudioCallbackRate());
+
+    // --- Cycle Counter ---
+    // The M7 DWT ignores writes until unlocked (a debugger does this for us)
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->LAR = 0xC5ACCE55;
+    DWT->CYCCNT = 0;
+    DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+}
+
+void Hardware::ConfigureSdramMpu()
+{
+    // The looper buffers are only touched by the CPU (no DMA), so the whole
+    // SDRAM bank can be normal memory, write-back / read-write allocate.
+    MPU_Region_InitTypeDef mpu;
+    HAL_MPU_Disable();
+    mpu.Enable           = MPU_REGION_ENABLE;
+    mpu.Number           = MPU_REGION_NUMBER7;
+    mpu.BaseAddress      = 0xC0000000;
+    mpu.Size             = MPU_REGION_SIZE_64MB;
+    mpu.SubRegionDisable = 0x00;
+    mpu.TypeExtField     = MPU_TEX_LEVEL1;
+    mpu.AccessPermission = MPU_REGION_FULL_ACCESS;
+    mpu.DisableExec      = MPU_INSTRUCTION_ACCESS_DISABLE;
+    mpu.IsShareable      = MPU_ACCESS_NOT_SHAREABLE;
+    mpu.IsCacheable      = MPU_ACCESS_CACHEABLE;
+    mpu.IsBufferable     = MPU_ACCESS_BUFFERABLE;
+    HAL_MPU_ConfigRegion(&mpu);
+    HAL_MPU_Enable(MPU_PRIVILEGED_DEFAULT);
 }
 
 void Hardware::ProcessControls()
@@ -8,6 +8,22 @@ using namespace daisysp;
 // 20 seconds @ 48kHz
 #define LOOPER_MAX_SAMPLES 960000
 
+// --- Memory Placement ---
+// With USE_TCM=1 the audio path is linked into ITCM and the engine state
+// into DTCM (see dust_tcm.ld). Otherwise the default placement is kept.
+// DUST_DTCM is zero-filled at startup: use it for objects that are zero or
+// set up by a constructor / Init(). Objects with constant initializers
+// (e.g. prebuilt tables) need DUST_DTCM_DATA, which is copied from flash.
+#ifdef DUST_USE_TCM
+#define DUST_ITCM      __attribute__((section(".dust_itcm"), long_call))
+#define DUST_DTCM      __attribute__((section(".dust_dtcm")))
+#define DUST_DTCM_DATA __attribute__((section(".dust_dtcm_data")))
+#else
+#define DUST_ITCM
+#define DUST_DTCM
+#define DUST_DTCM_DATA
+#endif
+
 struct Hardware
 {
     DaisySeed seed;
@@ -23,6 +39,18 @@ struct Hardware
     static float DSY_SDRAM_BSS buffer_a[LOOPER_MAX_SAMPLES];
     static float DSY_SDRAM_BSS buffer_b[LOOPER_MAX_SAMPLES];
 
+    // --- Profiling (DWT cycle counter, per audio callback) ---
+    uint32_t  cycles_start = 0;
+    uint32_t  cycles_last  = 0;
+    uint32_t  cycles_max   = 0;
+
     void Init();
     void ProcessControls(); 
+    void ConfigureSdramMpu();
+
+    inline void CycleStart() { cycles_start = DWT->CYCCNT; }
+    inline void CycleEnd() {
+        cycles_last = DWT->CYCCNT - cycles_start;
+        if (cycles_last > cycles_max) cycles_max = cycles_last;
+    }
 };
\ No newline at end of file
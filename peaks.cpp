@@ -0,0 +1,72 @@
+#include "peaks.h"
+#include <string.h>
+
+void PeakMap::Init()
+{
+    uint32_t offset = 0;
+    for (int l = 0; l < PEAK_LEVELS; l++) {
+        level_offset[l] = offset;
+        level_size[l] = (PEAK_BASE_BUCKETS + (1u << l) - 1) >> l;
+        offset += level_size[l];
+    }
+    Clear();
+}
+
+void PeakMap::Clear()
+{
+    // Empty buckets are marked by min > max
+    memset(mins, 127, sizeof(mins));
+    memset(maxs, -128, sizeof(maxs));
+    cur_bucket = -1;
+}
+
+void PeakMap::Commit()
+{
+    if (cur_bucket < 0 || (uint32_t)cur_bucket >= level_size[0]) return;
+
+    uint32_t idx = (uint32_t)cur_bucket;
+    mins[idx] = cur_min;
+    maxs[idx] = cur_max;
+
+    for (int l = 1; l < PEAK_LEVELS; l++) {
+        uint32_t child = level_offset[l - 1] + (idx & ~1u);
+        int8_t mn = mins[child];
+        int8_t mx = maxs[child];
+        if ((idx | 1u) < level_size[l - 1]) {
+            if (mins[child + 1] < mn) mn = mins[child + 1];
+            if (maxs[child + 1] > mx) mx = maxs[child + 1];
+        }
+        idx >>= 1;
+        mins[level_offset[l] + idx] = mn;
+        maxs[level_offset[l] + idx] = mx;
+    }
+}
+
+bool PeakMap::Query(uint32_t start, uint32_t end, float &mn, float &mx) const
+{
+    if (end <= start) return false;
+
+    // Coarsest level whose buckets are at most half the range. Buckets that
+    // straddle the range edges are still included, so this keeps the
+    // overreach small relative to the range (base level excepted).
+    uint32_t span = (end - start) >> PEAK_BASE_SHIFT;
+    int l = 0;
+    while (l < PEAK_LEVELS - 1 && (4u << l) <= span) l++;
+
+    uint32_t shift = PEAK_BASE_SHIFT + l;
+    uint32_t first = start >> shift;
+    uint32_t last = (end - 1) >> shift;
+    if (last >= level_size[l]) last = level_size[l] - 1;
+    if (first > last) return false;
+
+    int8_t lo = 127; int8_t hi = -128;
+    for (uint32_t i = first; i <= last; i++) {
+        uint32_t k = level_offset[l] + i;
+        if (mins[k] < lo) lo = mins[k];
+        if (maxs[k] > hi) hi = maxs[k];
+    }
+    if (lo > hi) return false;
+    mn = (float)lo / 127.0f;
+    mx = (float)hi / 127.0f;
+    return true;
+}
\ No newline at end of file
@@ -0,0 +1,57 @@
+#pragma once
+#include <stdint.h>
+#include "hw.h"
+
+// Samples summarised by one base-level bucket
+#define PEAK_BASE_SHIFT 8
+#define PEAK_BASE_BUCKETS ((LOOPER_MAX_SAMPLES + (1 << PEAK_BASE_SHIFT) - 1) >> PEAK_BASE_SHIFT)
+#define PEAK_LEVELS 12
+// Level sizes are rounded up, so allow one spare bucket per level
+#define PEAK_TOTAL_BUCKETS (PEAK_BASE_BUCKETS * 2 + PEAK_LEVELS)
+
+// Multi-resolution min/max summary of one looper buffer.
+// Level 0 holds one bucket per 256 samples, each level above halves the
+// count. Writers Push() samples as they store them; the pyramid is brought
+// up to date once per audio block with Commit(). Query() answers any range
+// by touching at most a few buckets.
+struct PeakMap
+{
+    int8_t   mins[PEAK_TOTAL_BUCKETS];
+    int8_t   maxs[PEAK_TOTAL_BUCKETS];
+    uint32_t level_offset[PEAK_LEVELS];
+    uint32_t level_size[PEAK_LEVELS];
+
+    // Bucket currently being accumulated
+    int32_t  cur_bucket = -1;
+    int8_t   cur_min;
+    int8_t   cur_max;
+
+    void Init();
+    void Clear();
+
+    inline void Push(uint32_t pos, float samp) {
+        int32_t b = (int32_t)(pos >> PEAK_BASE_SHIFT);
+        if (b != cur_bucket) {
+            Commit();
+            // A new bucket replaces whatever was there before
+            cur_bucket = b;
+            cur_min = 127; cur_max = -128;
+        }
+        int8_t q = Quantize(samp);
+        if (q < cur_min) cur_min = q;
+        if (q > cur_max) cur_max = q;
+    }
+
+    // Writes the open bucket and propagates it up the pyramid
+    void Commit();
+
+    // Min/max over samples [start, end), in -1..1. Returns false if empty.
+    bool Query(uint32_t start, uint32_t end, float &mn, float &mx) const;
+
+  private:
+    static inline int8_t Quantize(float s) {
+        if (s > 1.0f) s = 1.0f;
+        if (s < -1.0f) s = -1.0f;
+        return (int8_t)(s * 127.0f);
+    }
+};
\ No newline at end of file
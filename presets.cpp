@@ -0,0 +1,198 @@
+#include "presets.h"
+#include <string.h>
+#include <math.h>
+
+// Bump the low byte whenever the Param layout changes
+static const uint32_t kSceneMagic = 0x44535402;
+
+static_assert(sizeof(PresetStore::Record) <= PresetStore::kRecordStride, "Scenes must fit one record");
+static_assert(PresetStore::kRecordStride % PresetStore::kPageSize == 0, "Records must be page aligned");
+
+uint8_t DSY_QSPI_BSS __attribute__((aligned(PresetStore::kSectorSize)))
+    PresetStore::flash_region[kNumSectors * kSectorSize];
+
+uint32_t PresetStore::Crc(const Record &rec)
+{
+    // CRC-32 (reflected, 0xEDB88320) over seq and scenes
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(&rec.seq);
+    const uint8_t *end = reinterpret_cast<const uint8_t *>(&rec.crc);
+    uint32_t crc = 0xFFFFFFFF;
+    while (p < end) {
+        crc ^= *p++;
+        for (int b = 0; b < 8; b++) crc = (crc >> 1) ^ (0xEDB88320 & (0u - (crc & 1)));
+    }
+    return ~crc;
+}
+
+bool PresetStore::SlotValid(uint32_t slot) const
+{
+    const Record *rec = SlotRecord(slot);
+    if (rec->magic != kSceneMagic || rec->crc != Crc(*rec)) return false;
+    for (int s = 0; s < NUM_SCENES; s++)
+        for (int i = 0; i < SCENE_MAX_PARAMS; i++)
+            if (!isfinite(rec->scenes[s][i])) return false;
+    return true;
+}
+
+bool PresetStore::SlotBlank(uint32_t slot) const
+{
+    const uint8_t *p = flash_region + slot * kRecordStride;
+    for (uint32_t i = 0; i < kRecordStride; i++) if (p[i] != 0xFF) return false;
+    return true;
+}
+
+bool PresetStore::SectorBlank(uint32_t sector) const
+{
+    const uint8_t *p = flash_region + sector * kSectorSize;
+    for (uint32_t i = 0; i < kSectorSize; i++) if (p[i] != 0xFF) return false;
+    return true;
+}
+
+void PresetStore::OnFlashError(bool skip_sector)
+{
+    // The driver may have programmed part of the slot behind the cache
+    SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t *>(flash_region + write_slot * kRecordStride),
+                                 kRecordStride);
+    if (skip_sector) {
+        write_slot = NextSectorSlot(write_slot);
+        pre_erase = true;
+    }
+    write_state = WS_IDLE;
+
+    if (++failures >= kMaxRetries) {
+        // Stop retrying until the next Store()
+        failed = true;
+        written_seq = pending_seq;
+    }
+}
+
+void PresetStore::Init(const float *defaults, int num_params)
+{
+    int newest = -1;
+    for (uint32_t slot = 0; slot < kNumSlots; slot++) {
+        if (!SlotValid(slot)) continue;
+        if (newest < 0 || SlotRecord(slot)->seq > SlotRecord(newest)->seq) newest = (int)slot;
+    }
+
+    if (newest >= 0) {
+        memcpy(ram, SlotRecord(newest)->scenes, sizeof(ram));
+        flash_seq = SlotRecord(newest)->seq;
+        write_slot = (newest + 1) % kNumSlots;
+    } else {
+        memset(ram, 0, sizeof(ram));
+        for (int s = 0; s < NUM_SCENES; s++) memcpy(ram[s], defaults, num_params * sizeof(float));
+        flash_seq = 0;
+        write_slot = 0;
+    }
+    edit_seq = 0;
+    written_seq = 0;
+    write_state = WS_IDLE;
+    failures = 0;
+    failed = false;
+    // Stores should land in an erased sector once the current one fills
+    pre_erase = !SectorBlank(UpcomingSector());
+}
+
+void PresetStore::Store(int scene, const float *params, int num_params)
+{
+    if (scene < 0 || scene >= NUM_SCENES) return;
+    memcpy(ram[scene], params, num_params * sizeof(float));
+    failures = 0;
+    failed = false;
+    edit_seq = edit_seq + 1;
+}
+
+void PresetStore::Load(int scene, float *params, int num_params) const
+{
+    if (scene < 0 || scene >= NUM_SCENES) return;
+    memcpy(params, ram[scene], num_params * sizeof(float));
+}
+
+void PresetStore::Step(QSPIHandle &qspi)
+{
+    uint32_t base = reinterpret_cast<uint32_t>(flash_region);
+
+    switch (write_state) {
+        case WS_IDLE: {
+            uint32_t seq = edit_seq;
+            if (seq == written_seq) {
+                if (pre_erase) write_state = WS_PRE_ERASE;
+                return;
+            }
+            // Store() runs in the audio callback; retry if it landed mid-copy
+            memcpy(write_record.scenes, ram, sizeof(ram));
+            if (seq != edit_seq) return;
+            pending_seq = seq;
+            write_record.magic = kSceneMagic;
+            write_record.seq = flash_seq + 1;
+            write_record.crc = Crc(write_record);
+            write_state = WS_PREPARE;
+            break;
+        }
+        case WS_PREPARE:
+            if (SlotBlank(write_slot)) {
+                write_page = 1;
+                write_state = WS_PROGRAM;
+            } else {
+                // Used or torn slot: start over at a sector boundary, which
+                // never holds the newest record (it sits just behind us)
+                if (write_slot % kRecordsPerSector != 0)
+                    write_slot = (write_slot / kRecordsPerSector + 1) * kRecordsPerSector % kNumSlots;
+                write_state = WS_ERASE;
+            }
+            break;
+        case WS_ERASE: {
+            uint32_t sector = base + (write_slot / kRecordsPerSector) * kSectorSize;
+            if (qspi.Erase(sector, sector + kSectorSize) != QSPIHandle::Result::OK) {
+                OnFlashError(false);
+                return;
+            }
+            SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t *>(flash_region + (sector - base)), kSectorSize);
+            write_page = 1;
+            write_state = WS_PROGRAM;
+            break;
+        }
+        case WS_PROGRAM: {
+            // Pages 1..N first, the header page (magic, seq) last
+            uint32_t offset = write_page * kPageSize;
+            uint32_t n = sizeof(Record) > offset ? sizeof(Record) - offset : 0;
+            if (n > kPageSize) n = kPageSize;
+            if (n > 0) {
+                uint8_t *src = reinterpret_cast<uint8_t *>(&write_record) + offset;
+                uint32_t addr = base + write_slot * kRecordStride + offset;
+                if (qspi.Write(addr, n, src) != QSPIHandle::Result::OK) {
+                    // Retry in the next sector; PREPARE erases it
+                    OnFlashError(true);
+                    return;
+                }
+            }
+            if (write_page == 0) {
+                SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t *>(flash_region + write_slot * kRecordStride),
+                                             kRecordStride);
+                flash_seq = write_record.seq;
+                written_seq = pending_seq;
+                failures = 0;
+                // Entered a new sector: clear the next one while idle
+                if (write_slot % kRecordsPerSector == 0) pre_erase = true;
+                write_slot = (write_slot + 1) % kNumSlots;
+                write_state = WS_IDLE;
+            } else {
+                write_page = (offset + kPageSize < sizeof(Record)) ? write_page + 1 : 0;
+            }
+            break;
+        }
+        case WS_PRE_ERASE: {
+            uint32_t next = UpcomingSector();
+            uint32_t sector = base + next * kSectorSize;
+            write_state = WS_IDLE;
+            if (qspi.Erase(sector, sector + kSectorSize) != QSPIHandle::Result::OK) {
+                // Leave it to PREPARE rather than retrying forever
+                if (++failures >= kMaxRetries) pre_erase = false;
+                return;
+            }
+            SCB_InvalidateDCache_by_Addr(reinterpret_cast<uint32_t *>(flash_region + next * kSectorSize), kSectorSize);
+            pre_erase = false;
+            break;
+        }
+    }
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#pragma once
+#include "daisy_seed.h"
+#include "config.h"
+
+using namespace daisy;
+
+// Preset scenes backed by QSPI flash.
+// The audio side only touches the RAM copy: Store() edits it and bumps a
+// sequence number, Load() reads it, so recall never waits on flash.
+//
+// Flash holds an append-only log of full snapshots (records) spread over a
+// few sectors. Each record carries a sequence number and a CRC, and its
+// header page is programmed last, so a torn write is never loaded. Step()
+// runs from the main loop and does one page program (well under 1 ms) per
+// call. When the log enters a sector, the next one is erased while idle,
+// so a store normally never waits on an erase. The erase itself still
+// blocks the main loop (not audio) for tens of ms, since the QSPI driver
+// polls until it finishes.
+struct PresetStore
+{
+    static const uint32_t kSectorSize       = 4096;
+    static const uint32_t kPageSize         = 256;
+    static const uint32_t kNumSectors       = 4;
+    static const uint32_t kRecordStride     = 1280; // Page aligned
+    static const uint32_t kRecordsPerSector = kSectorSize / kRecordStride;
+    static const uint32_t kNumSlots         = kNumSectors * kRecordsPerSector;
+    static const uint32_t kMaxRetries       = 3;
+
+    struct Record {
+        uint32_t magic;
+        uint32_t seq;
+        float    scenes[NUM_SCENES][SCENE_MAX_PARAMS];
+        uint32_t crc;     // Over seq and scenes
+    };
+
+    enum WriteState { WS_IDLE, WS_PREPARE, WS_ERASE, WS_PROGRAM, WS_PRE_ERASE };
+
+    float             ram[NUM_SCENES][SCENE_MAX_PARAMS];
+    Record            write_record;     // Snapshot being written
+    volatile uint32_t edit_seq = 0;     // Bumped by Store()
+    uint32_t          written_seq = 0;  // Last edit safely in flash
+    uint32_t          pending_seq = 0;
+    uint32_t          flash_seq = 0;    // Sequence of the newest record
+    uint32_t          write_slot = 0;
+    uint32_t          write_page = 0;
+    WriteState        write_state = WS_IDLE;
+    bool              pre_erase = false;  // Next sector still needs erasing
+    uint32_t          failures = 0;       // Consecutive flash errors
+    bool              failed = false;     // Gave up on the last edit
+
+    static uint8_t    flash_region[kNumSectors * kSectorSize];
+
+    // Loads the newest valid record, or fills every slot with defaults
+    void Init(const float *defaults, int num_params);
+
+    void Store(int scene, const float *params, int num_params);
+    void Load(int scene, float *params, int num_params) const;
+    bool Busy() const { return edit_seq != written_seq; }
+    bool Failed() const { return failed; }
+
+    // One bounded flash operation; call periodically from the main loop
+    void Step(QSPIHandle &qspi);
+
+  private:
+    const Record* SlotRecord(uint32_t slot) const {
+        return reinterpret_cast<const Record *>(flash_region + slot * kRecordStride);
+    }
+    bool SlotValid(uint32_t slot) const;
+    bool SlotBlank(uint32_t slot) const;
+    bool SectorBlank(uint32_t sector) const;
+    void OnFlashError(bool skip_sector);
+    static uint32_t NextSectorSlot(uint32_t slot) {
+        return (slot / kRecordsPerSector + 1) * kRecordsPerSector % kNumSlots;
+    }
+    // Sector the log writes into next once the current one is used up.
+    // Never the one holding the newest record (write_slot - 1).
+    uint32_t UpcomingSector() const {
+        uint32_t slot = (write_slot % kRecordsPerSector == 0) ? write_slot : NextSectorSlot(write_slot);
+        return slot / kRecordsPerSector;
+    }
+    static uint32_t Crc(const Record &rec);
+};
\ No newline at end of file
@@ -20,7 +20,11 @@ const MenuItem kItemsGrain[] = {
     {"Size",     TYPE_PARAM, PARAM_GRAIN_SIZE},
     {"Density",  TYPE_PARAM, PARAM_GRAINS},
     {"Spray",    TYPE_PARAM, PARAM_SPRAY},
-    {"Stereo",   TYPE_PARAM, PARAM_STEREO}
+    {"Stereo",   TYPE_PARAM, PARAM_STEREO},
+    {"Cutoff",   TYPE_PARAM, PARAM_FILTER_CUTOFF},
+    {"Cut Sprd", TYPE_PARAM, PARAM_FILTER_SPREAD},
+    {"Reso",     TYPE_PARAM, PARAM_FILTER_RES},
+    {"Tilt",     TYPE_PARAM, PARAM_FILTER_TILT}
 };
 
 const MenuItem kItemsTime[] = {
@@ -28,6 +32,13 @@ const MenuItem kItemsTime[] = {
     {"Div",      TYPE_PARAM, PARAM_DIVISION}
 };
 
+const MenuItem kItemsScene[] = {
+    {"Scene",    TYPE_PARAM,  PARAM_SCENE},
+    {"Morph",    TYPE_PARAM,  PARAM_MORPH_TIME},
+    {"Recall",   TYPE_ACTION, ACTION_SCENE_RECALL},
+    {"Store",    TYPE_ACTION, ACTION_SCENE_STORE}
+};
+
 const MenuItem kItemsLooper[] = {
     {"(Visual Only)", TYPE_PARAM, -1}
 };
@@ -40,18 +51,30 @@ const MenuPage kPages[] = {
     {"MIX",    kItemsMix,    sizeof(kItemsMix)/sizeof(MenuItem)},
     {"GRAIN",  kItemsGrain,  sizeof(kItemsGrain)/sizeof(MenuItem)},
     {"TIME",   kItemsTime,   sizeof(kItemsTime)/sizeof(MenuItem)},
+    {"SCENE",  kItemsScene,  sizeof(kItemsScene)/sizeof(MenuItem)},
     {"LOOPER", kItemsLooper, 0}
 };
 const int kNumPages = sizeof(kPages) / sizeof(MenuPage);
 
-Processing::Grain Processing::grains_l[MAX_GRAINS];
-Processing::Grain Processing::grains_r[MAX_GRAINS];
+static_assert(kSceneParams <= SCENE_MAX_PARAMS, "Raise SCENE_MAX_PARAMS");
+
+Processing::Grain DUST_DTCM Processing::grains[MAX_GRAINS];
+Processing::GrainFilters DUST_DTCM Processing::filters;
+float DUST_DTCM Processing::pan_table_l[PAN_TABLE_SIZE];
+float DUST_DTCM Processing::pan_table_r[PAN_TABLE_SIZE];
+PeakMap Processing::peaks_a;
+PeakMap Processing::peaks_b;
 
 void Processing::Init(Hardware &hw)
 {
     sample_rate_ = hw.sample_rate;
+    callback_rate_ = hw.seed.AudioCallbackRate();
+    // ~20 ms glide for knob edits
+    param_smooth_ = 1.0f - expf(-1.0f / (0.02f * callback_rate_));
     active_buffer = hw.buffer_a;
     rec_buffer    = hw.buffer_b;
+    peaks_a.Init();
+    peaks_b.Init();
     ResetLooper(hw);
 
     params[PARAM_PRE_GAIN] = 0.5f; params[PARAM_FEEDBACK] = 0.5f; params[PARAM_MIX] = 0.5f;
@@ -59,10 +82,15 @@ void Processing::Init(Hardware &hw)
     params[PARAM_PITCH] = 1.0f; params[PARAM_GRAIN_SIZE] = 0.1f; params[PARAM_GRAINS] = 10.0f; 
     params[PARAM_SPRAY] = 0.0f; params[PARAM_STEREO] = 0.0f;
     params[PARAM_MAP_AMT] = 0.0f; 
-    
-    for(int i=0; i<PARAM_COUNT; i++) effective_params[i] = params[i];
+    params[PARAM_FILTER_CUTOFF] = 0.5f; params[PARAM_FILTER_SPREAD] = 0.0f;
+    params[PARAM_FILTER_RES] = 0.0f; params[PARAM_FILTER_TILT] = 0.5f;
+    params[PARAM_SCENE] = 1.0f; params[PARAM_MORPH_TIME] = 0.0f;
     
     division_idx = 0; params[PARAM_DIVISION] = (float)division_vals[division_idx];
+
+    for(int i=0; i<PARAM_COUNT; i++) effective_params[i] = params[i];
+    morph_pos = 1.0f;
+    presets.Init(params, kSceneParams);
     
     current_page_idx = 0;
     advanced_mode = false;
@@ -71,6 +99,15 @@ void Processing::Init(Hardware &hw)
     enc1_holding = false;
     trigger_blink = false;
 
+    filters.Init(sample_rate_);
+
+    // Constant-power pan law: L = cos, R = sin over a quarter turn
+    for(int i = 0; i < PAN_TABLE_SIZE; i++) {
+        float angle = (float)i / (float)(PAN_TABLE_SIZE - 1) * HALFPI_F;
+        pan_table_l[i] = cosf(angle);
+        pan_table_r[i] = sinf(angle);
+    }
+
     UpdateBufferLen();
     UpdateGrainParams();
 }
@@ -82,8 +119,11 @@ void Processing::ResetLooper(Hardware &hw) {
     loop_len = 0;
     active_buffer = hw.buffer_a;
     rec_buffer    = hw.buffer_b;
+    active_peaks  = &peaks_a;
+    rec_peaks     = &peaks_b;
     write_pos = 0;
     memset(active_buffer, 0, LOOPER_MAX_SAMPLES * sizeof(float));
+    active_peaks->Clear();
     
     // Reset flags
     btn1_held_event = false;
@@ -160,6 +200,7 @@ void Processing::Controls(Hardware &hw)
                     looper_state = LP_REC;
                     rec_pos = 0;
                     memset(rec_buffer, 0, LOOPER_MAX_SAMPLES * sizeof(float));
+                    rec_peaks->Clear();
                 } 
                 else if (looper_state == LP_REC) {
                     // Finish Rec -> Play
@@ -171,6 +212,9 @@ void Processing::Controls(Hardware &hw)
                     float* temp = active_buffer;
                     active_buffer = rec_buffer;
                     rec_buffer = temp;
+                    PeakMap* temp_peaks = active_peaks;
+                    active_peaks = rec_peaks;
+                    rec_peaks = temp_peaks;
                     
                     play_pos = 0;
                 } 
@@ -179,6 +223,7 @@ void Processing::Controls(Hardware &hw)
                     looper_state = LP_REC;
                     rec_pos = 0;
                     memset(rec_buffer, 0, LOOPER_MAX_SAMPLES * sizeof(float));
+                    rec_peaks->Clear();
                 }
                 else if (looper_state == LP_STOP) {
                     looper_state = LP_PLAY;
@@ -204,7 +249,10 @@ void Processing::Controls(Hardware &hw)
         if(enc1_holding) {
             enc1_holding = false;
             const MenuItem &item = GetSelectedItem();
-            if (ui_state == STATE_MENU_NAV && item.param_id >= 0) {
+            if (ui_state == STATE_MENU_NAV && item.type == TYPE_ACTION) {
+                DoAction(item.param_id);
+                trigger_blink = true;
+            } else if (ui_state == STATE_MENU_NAV && item.param_id >= 0) {
                  edit_param_target = item.param_id;
                  ui_state = STATE_PARAM_EDIT;
             } else {
@@ -235,16 +283,62 @@ void Processing::Controls(Hardware &hw)
                 case PARAM_PITCH: val += (float)inc * 0.05f; break;
                 case PARAM_GRAIN_SIZE: val = fclamp(val + (float)inc * 0.005f, 0.002f, 0.5f); break;
                 case PARAM_GRAINS: val = fclamp(val + (float)inc, 0.5f, 50.0f); break;
+                case PARAM_SCENE: val = fclamp(val + (float)inc, 1.0f, (float)NUM_SCENES); break;
                 default: val = fclamp(val + (float)inc * delta, 0.0f, 1.0f); break;
             }
-            effective_params[edit_param_target] = val;
         }
     }
 
+    // Block-rate parameter update; GetSample only reads the results
+    UpdateEffectiveParams();
     UpdateBufferLen();
     UpdateGrainParams();
 }
 
+void Processing::DoAction(int action) {
+    int scene = (int)params[PARAM_SCENE] - 1;
+    switch(action) {
+        case ACTION_SCENE_RECALL: RecallScene(scene); break;
+        case ACTION_SCENE_STORE:  presets.Store(scene, params, kSceneParams); break;
+        default: break;
+    }
+}
+
+void Processing::RecallScene(int scene) {
+    for(int i = 0; i < PARAM_COUNT; i++) morph_from[i] = effective_params[i];
+    presets.Load(scene, params, kSceneParams);
+
+    division_idx = 0;
+    for(int i = 0; i < 4; i++) if((float)division_vals[i] == params[PARAM_DIVISION]) division_idx = i;
+    params[PARAM_DIVISION] = (float)division_vals[division_idx];
+
+    float morph_blocks = params[PARAM_MORPH_TIME] * MAX_MORPH_SECONDS * callback_rate_;
+    if (morph_blocks < 1.0f) {
+        // Instant recall: the ~20 ms edit glide still smooths the jump
+        morph_pos = 1.0f;
+    } else {
+        morph_pos = 0.0f;
+        morph_inc = 1.0f / morph_blocks;
+    }
+}
+
+void Processing::UpdateEffectiveParams() {
+    if (morph_pos < 1.0f) {
+        // Scene morph: straight line from the recalled-from state to params
+        morph_pos += morph_inc;
+        if (morph_pos > 1.0f) morph_pos = 1.0f;
+        for(int i = 0; i < kSceneParams; i++) {
+            effective_params[i] = morph_from[i] + (params[i] - morph_from[i]) * morph_pos;
+        }
+    } else {
+        // Knob edits: one-pole glide instead of a jump
+        for(int i = 0; i < kSceneParams; i++) {
+            float d = params[i] - effective_params[i];
+            effective_params[i] = (fabsf(d) < 1e-5f) ? params[i] : effective_params[i] + d * param_smooth_;
+        }
+    }
+}
+
 void Processing::UpdateBufferLen() {
     if (looper_state == LP_PLAY || looper_state == LP_STOP) {
         buffer_len_samples = loop_len;
@@ -263,16 +357,25 @@ void Processing::UpdateGrainParams() {
     float density_hz = effective_params[PARAM_GRAINS]; 
     if(density_hz < 0.1f) density_hz = 0.1f; 
     float base_int = sample_rate_ / density_hz;
-    float stereo = effective_params[PARAM_STEREO];
     
-    grain_trig_interval_l = (uint32_t)(base_int * ((1.0f - stereo) + (rand_.Process() * stereo)));
-    grain_trig_interval_r = (uint32_t)(base_int * ((1.0f - stereo) + (rand_.Process() * stereo)));
-    
-    if(grain_trig_interval_l == 0) grain_trig_interval_l = 1;
-    if(grain_trig_interval_r == 0) grain_trig_interval_r = 1;
+    grain_trig_interval = (uint32_t)base_int;
+    if(grain_trig_interval == 0) grain_trig_interval = 1;
+
+    grain_size_samples = (uint32_t)(effective_params[PARAM_GRAIN_SIZE] * sample_rate_);
+
+    float tilt = effective_params[PARAM_FILTER_TILT];
+    filter_lp_amt = (tilt < 0.5f) ? (0.5f - tilt) * 2.0f : 0.0f;
+    filter_hp_amt = (tilt > 0.5f) ? (tilt - 0.5f) * 2.0f : 0.0f;
 }
 
-void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
+float Processing::GrainCutoffHz() {
+    // Each grain gets its own cutoff, scattered around the base by the spread
+    float spread = effective_params[PARAM_FILTER_SPREAD];
+    float norm = effective_params[PARAM_FILTER_CUTOFF] + spread * (rand_.Process() - 0.5f);
+    return 20.0f * powf(1000.0f, fclamp(norm, 0.0f, 1.0f));
+}
+
+DUST_ITCM void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
     float pre_gain = effective_params[PARAM_PRE_GAIN] * 2.0f; 
     float fbk = effective_params[PARAM_FEEDBACK];
     float mix = effective_params[PARAM_MIX]; 
@@ -290,44 +393,39 @@ void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
         float spray = effective_params[PARAM_SPRAY];
 
         // Trigger Logic
-        if(grain_trig_counter_l == 0) {
-            float sz_mod = (1.0f - stereo) + (rand_.Process() * stereo);
-            uint32_t sz = (uint32_t)(effective_params[PARAM_GRAIN_SIZE] * sample_rate_ * sz_mod);
-            
+        if(grain_trig_counter == 0) {
             float cursor = (looper_state == LP_EMPTY) ? (float)write_pos : (float)play_pos;
             float start = cursor - (rand_.Process() * spray * 0.5f * sample_rate_);
+
+            // Stereo spreads grains around the centre of the pan law
+            float pan = 0.5f + (rand_.Process() - 0.5f) * stereo;
+            int pan_idx = (int)(pan * (float)(PAN_TABLE_SIZE - 1) + 0.5f);
             
             for(int i = 0; i < MAX_GRAINS; i++) { 
-                if(!grains_l[i].active) { 
-                    grains_l[i].Start(start, effective_params[PARAM_PITCH], sz, sample_rate_, buffer_len_samples); 
+                if(!grains[i].active) { 
+                    grains[i].Start(start, effective_params[PARAM_PITCH], grain_size_samples, sample_rate_, buffer_len_samples,
+                                    pan_table_l[pan_idx], pan_table_r[pan_idx]); 
+                    filters.Start(i, GrainCutoffHz(), effective_params[PARAM_FILTER_RES], sample_rate_);
                     break; 
                 }
             }
-            UpdateGrainParams(); grain_trig_counter_l = grain_trig_interval_l;
-        } grain_trig_counter_l--;
+            grain_trig_counter = grain_trig_interval;
+        } grain_trig_counter--;
 
-        if(grain_trig_counter_r == 0) {
-            float sz_mod = (1.0f - stereo) + (rand_.Process() * stereo);
-            uint32_t sz = (uint32_t)(effective_params[PARAM_GRAIN_SIZE] * sample_rate_ * sz_mod);
-            
-            float cursor = (looper_state == LP_EMPTY) ? (float)write_pos : (float)play_pos;
-            float start = cursor - (rand_.Process() * spray * 0.5f * sample_rate_);
+        // Render grains once, filter them as one batch, then pan into both outputs
+        float grain_out[GrainFilters::kSlots];
+        for(int i = 0; i < MAX_GRAINS; i++) { 
+            grain_out[i] = grains[i].Process(active_buffer, buffer_len_samples); 
+        }
 
-            for(int i = 0; i < MAX_GRAINS; i++) { 
-                if(!grains_r[i].active) { 
-                    grains_r[i].Start(start, effective_params[PARAM_PITCH], sz, sample_rate_, buffer_len_samples); 
-                    break; 
-                }
-            }
-            grain_trig_counter_r = grain_trig_interval_r;
-        } grain_trig_counter_r--;
+        filters.Process(grain_out, filter_lp_amt, filter_hp_amt);
 
-        // Sum active grains
         for(int i = 0; i < MAX_GRAINS; i++) { 
-            wet_l += grains_l[i].Process(active_buffer, buffer_len_samples); 
-            wet_r += grains_r[i].Process(active_buffer, buffer_len_samples); 
+            wet_l += grain_out[i] * grains[i].gain_l; 
+            wet_r += grain_out[i] * grains[i].gain_r; 
         }
-        wet_l *= 0.5f; wet_r *= 0.5f;
+        // Centred grains land at the same level as the old per-side pools
+        wet_l *= 0.7071f; wet_r *= 0.7071f;
     }
 
     // 3. Buffer Writing (Rec / Live)
@@ -338,6 +436,7 @@ void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
         // Resampling: Record Input + (GranularOutput * Feedback)
         if (rec_pos < LOOPER_MAX_SAMPLES) {
             rec_buffer[rec_pos] = wet_in + (granular_sum * fbk);
+            rec_peaks->Push(rec_pos, rec_buffer[rec_pos]);
             rec_pos++;
         }
     } 
@@ -346,6 +445,7 @@ void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
         // Note: In Live mode, we usually feed the input + feedback(delay style)
         float old_samp = active_buffer[write_pos];
         active_buffer[write_pos] = fclamp(wet_in + (old_samp * fbk), -1.0f, 1.0f);
+        active_peaks->Push(write_pos, active_buffer[write_pos]);
         write_pos++;
         if (write_pos >= buffer_len_samples) write_pos = 0;
     }
@@ -359,4 +459,10 @@ void Processing::GetSample(float &outl, float &outr, float inl, float inr) {
     // 5. Final Output
     outl = (inl * pre_gain * (1.0f - mix) + wet_l * mix) * post_gain; 
     outr = (inr * pre_gain * (1.0f - mix) + wet_r * mix) * post_gain;
+}
+
+void Processing::EndBlock() {
+    // Publish the partially filled buckets once per block
+    if (looper_state == LP_REC) rec_peaks->Commit();
+    else if (looper_state == LP_EMPTY) active_peaks->Commit();
 }
\ No newline at end of file
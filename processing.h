@@ -2,6 +2,8 @@
 #include "daisysp.h"
 #include "hw.h"
 #include "config.h"
+#include "peaks.h"
+#include "presets.h"
 
 using namespace daisy;
 using namespace daisysp;
@@ -12,10 +14,17 @@ enum Param {
     PARAM_BPM, PARAM_DIVISION,
     PARAM_PITCH, PARAM_GRAIN_SIZE, PARAM_GRAINS, PARAM_SPRAY, PARAM_STEREO,
     PARAM_MAP_AMT, 
+    PARAM_FILTER_CUTOFF, PARAM_FILTER_SPREAD, PARAM_FILTER_RES, PARAM_FILTER_TILT,
+    PARAM_SCENE, PARAM_MORPH_TIME, // Scene controls, not stored in scenes
     PARAM_COUNT
 };
 
-enum MenuItemType { TYPE_PARAM };
+// Params below this index make up a scene
+const int kSceneParams = PARAM_SCENE;
+
+enum MenuItemType { TYPE_PARAM, TYPE_ACTION };
+
+enum Action { ACTION_SCENE_RECALL, ACTION_SCENE_STORE };
 
 // --- Menu Structures ---
 struct MenuItem {
@@ -39,12 +48,17 @@ struct Processing
         float    increment;
         float    env_pos;
         float    env_inc;
+        float    gain_l;
+        float    gain_r;
         uint32_t size_samples;
         
         inline float TriEnv(float pos) { return (pos < 0.5f) ? pos * 2.0f : (1.0f - pos) * 2.0f; }
 
-        void Start(float start_pos, float pitch, uint32_t size_samps, float sample_rate, size_t buffer_len) {
+        void Start(float start_pos, float pitch, uint32_t size_samps, float sample_rate, size_t buffer_len,
+                   float pan_l, float pan_r) {
             active = true;
+            gain_l = pan_l;
+            gain_r = pan_r;
             while(start_pos < 0.0f) start_pos += (float)buffer_len;
             while(start_pos >= (float)buffer_len) start_pos -= (float)buffer_len;
             read_pos = start_pos;
@@ -54,7 +68,7 @@ struct Processing
             env_inc = 1.0f / (float)size_samples;
         }
 
-        float Process(float *buffer, size_t buffer_len) {
+        DUST_ITCM float Process(float *buffer, size_t buffer_len) {
             if(!active) return 0.0f;
             int32_t i_idx = (int32_t)read_pos;
             float frac = read_pos - i_idx;
@@ -71,6 +85,53 @@ struct Processing
         }
     };
 
+    // Per-grain 2-pole state-variable filters (TPT form), one slot per grain.
+    // State and coefficients live in parallel arrays so every slot runs in
+    // one tight loop; coefficients are only computed when a grain starts.
+    struct GrainFilters {
+        static const int kSlots = MAX_GRAINS;
+        float ic1[kSlots];
+        float ic2[kSlots];
+        float a1[kSlots];
+        float a2[kSlots];
+        float a3[kSlots];
+        float k[kSlots];
+
+        void Init(float sample_rate) {
+            for(int s = 0; s < kSlots; s++) {
+                ic1[s] = 0.0f;
+                ic2[s] = 0.0f;
+                Start(s, 1000.0f, 0.0f, sample_rate);
+            }
+        }
+
+        // Only retunes the slot: the previous grain's resonant tail may
+        // still be ringing, and zeroing the state would click.
+        void Start(int slot, float freq, float res, float sample_rate) {
+            freq = fclamp(freq, 20.0f, sample_rate * 0.45f);
+            float g = tanf(PI_F * freq / sample_rate);
+            k[slot]  = 2.0f - 1.95f * res;
+            a1[slot] = 1.0f / (1.0f + g * (g + k[slot]));
+            a2[slot] = g * a1[slot];
+            a3[slot] = g * a2[slot];
+        }
+
+        // Filters io[] in place. lp_amt / hp_amt crossfade from dry to the
+        // low-pass / high-pass outputs (the tilt control).
+        DUST_ITCM void Process(float *io, float lp_amt, float hp_amt) {
+            for(int s = 0; s < kSlots; s++) {
+                float v0 = io[s];
+                float v3 = v0 - ic2[s];
+                float v1 = a1[s] * ic1[s] + a2[s] * v3;
+                float v2 = ic2[s] + a2[s] * ic1[s] + a3[s] * v3;
+                ic1[s] = 2.0f * v1 - ic1[s];
+                ic2[s] = 2.0f * v2 - ic2[s];
+                float high = v0 - k[s] * v1 - v2;
+                io[s] = v0 + (v2 - v0) * lp_amt + (high - v0) * hp_amt;
+            }
+        }
+    };
+
     struct Rand {
         uint32_t seed_ = 1;
         float Process() {
@@ -85,6 +146,12 @@ struct Processing
     // --- Audio Buffers ---
     float* active_buffer;   // Buffer currently being granulated
     float* rec_buffer;      // Buffer currently being recorded to
+
+    // --- Waveform Summaries (follow their buffers on swap) ---
+    static PeakMap  peaks_a;
+    static PeakMap  peaks_b;
+    PeakMap*        active_peaks;
+    PeakMap*        rec_peaks;
     
     uint32_t    rec_pos = 0;
     uint32_t    play_pos = 0;    
@@ -95,12 +162,17 @@ struct Processing
     uint32_t        write_pos = 0;      
     uint32_t        buffer_len_samples = 48000;
     
-    static Grain    grains_l[MAX_GRAINS];
-    static Grain    grains_r[MAX_GRAINS];
-    uint32_t        grain_trig_counter_l = 0;
-    uint32_t        grain_trig_counter_r = 0;
-    uint32_t        grain_trig_interval_l = 2400; 
-    uint32_t        grain_trig_interval_r = 2400; 
+    static Grain    grains[MAX_GRAINS];
+    static GrainFilters filters;
+    static float    pan_table_l[PAN_TABLE_SIZE];
+    static float    pan_table_r[PAN_TABLE_SIZE];
+    uint32_t        grain_trig_counter = 0;
+    uint32_t        grain_trig_interval = 2400; 
+
+    // Derived once per block from effective_params
+    uint32_t        grain_size_samples = 4800;
+    float           filter_lp_amt = 0.0f;
+    float           filter_hp_amt = 0.0f;
 
     // --- Parameters ---
     float           params[PARAM_COUNT];           
@@ -109,8 +181,16 @@ struct Processing
     int             division_idx = 0; 
     const int       division_vals[4] = {1, 2, 4, 8}; 
     float           sample_rate_ = 48000.0f;
+    float           callback_rate_ = 12000.0f;
     Rand            rand_;
 
+    // --- Scenes / Morph ---
+    PresetStore     presets;
+    float           morph_from[PARAM_COUNT];
+    float           morph_pos = 1.0f;     // 1 = settled on params
+    float           morph_inc = 0.0f;
+    float           param_smooth_ = 1.0f; // One-pole coefficient for edits
+
     // --- UI State ---
     UiState         ui_state = STATE_MENU_NAV;
     bool            advanced_mode = false;
@@ -138,12 +218,17 @@ struct Processing
 
     void Init(Hardware &hw);
     void Controls(Hardware &hw);
-    void GetSample(float &outl, float &outr, float inl, float inr);
+    DUST_ITCM void GetSample(float &outl, float &outr, float inl, float inr);
+    void EndBlock();
     
     // Helpers
     void ResetLooper(Hardware &hw);
     void UpdateBufferLen();
     void UpdateGrainParams();
+    void UpdateEffectiveParams();
+    float GrainCutoffHz();
+    void DoAction(int action);
+    void RecallScene(int scene);
     void SetPage(int page_idx);
     void SetAdvancedMode(bool enabled);
     const MenuItem& GetSelectedItem() { return current_menu_items[selected_item_idx]; }
@@ -0,0 +1,77 @@
+#include "scheduler.h"
+
+int Scheduler::Add(const char* name, TaskFn fn, void* ctx, uint8_t priority,
+                   uint32_t period_ms, uint32_t delay_ms, uint32_t slack_ms)
+{
+    uint32_t now = System::GetNow();
+    for (int i = 0; i < MAX_TASKS; i++) {
+        Task &t = tasks[i];
+        if (t.active) continue;
+        t.name = name;
+        t.fn = fn;
+        t.ctx = ctx;
+        t.priority = priority;
+        t.period_ms = period_ms;
+        t.due_ms = now + delay_ms;
+        t.deadline_ms = t.due_ms + slack_ms;
+        t.runs = 0;
+        t.missed = 0;
+        t.last_run_us = 0;
+        t.max_run_us = 0;
+        t.active = true;
+        return i;
+    }
+    return -1;
+}
+
+int Scheduler::AddPeriodic(const char* name, TaskFn fn, void* ctx, uint8_t priority, uint32_t period_ms) {
+    if (period_ms == 0) period_ms = 1;
+    return Add(name, fn, ctx, priority, period_ms, 0, period_ms);
+}
+
+int Scheduler::AddOneShot(const char* name, TaskFn fn, void* ctx, uint8_t priority, uint32_t delay_ms, uint32_t slack_ms) {
+    return Add(name, fn, ctx, priority, 0, delay_ms, slack_ms);
+}
+
+bool Scheduler::Poll()
+{
+    uint32_t now = System::GetNow();
+
+    // Pick the most urgent due task
+    int pick = -1;
+    for (int i = 0; i < MAX_TASKS; i++) {
+        const Task &t = tasks[i];
+        if (!t.active || (int32_t)(now - t.due_ms) < 0) continue;
+        if (pick < 0) { pick = i; continue; }
+        const Task &p = tasks[pick];
+        if (t.priority < p.priority ||
+            (t.priority == p.priority && (int32_t)(t.deadline_ms - p.deadline_ms) < 0)) {
+            pick = i;
+        }
+    }
+    if (pick < 0) return false;
+
+    Task &t = tasks[pick];
+    if ((int32_t)(now - t.deadline_ms) > 0) t.missed++;
+
+    if (t.period_ms > 0) {
+        // Keep the grid; if we fell behind by whole periods, skip them
+        t.due_ms += t.period_ms;
+        if ((int32_t)(now - t.due_ms) >= 0) {
+            uint32_t behind = (now - t.due_ms) / t.period_ms + 1;
+            t.missed += behind;
+            t.due_ms += behind * t.period_ms;
+        }
+        t.deadline_ms = t.due_ms + t.period_ms;
+    }
+
+    uint32_t start_us = System::GetUs();
+    t.fn(t.ctx);
+    t.last_run_us = System::GetUs() - start_us;
+    if (t.last_run_us > t.max_run_us) t.max_run_us = t.last_run_us;
+    t.runs++;
+
+    // One-shots free their slot after running
+    if (t.period_ms == 0) t.active = false;
+    return true;
+}
\ No newline at end of file
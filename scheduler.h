@@ -0,0 +1,46 @@
+#pragma once
+#include "daisy_seed.h"
+
+using namespace daisy;
+
+// Max tasks registered at once
+#define MAX_TASKS 8
+
+// Cooperative, non-blocking scheduler for the main loop.
+// Each Poll() runs at most one due task: the one with the highest priority
+// (lowest value), earliest deadline first among equals. Tasks must return
+// quickly and split long jobs into steps.
+struct Scheduler
+{
+    typedef void (*TaskFn)(void *ctx);
+
+    struct Task {
+        bool        active = false;
+        const char* name;
+        TaskFn      fn;
+        void*       ctx;
+        uint8_t     priority;      // 0 = most urgent
+        uint32_t    period_ms;     // 0 = one-shot
+        uint32_t    due_ms;        // Earliest start time
+        uint32_t    deadline_ms;   // Latest start time before counting a miss
+
+        // --- Stats ---
+        uint32_t    runs;
+        uint32_t    missed;
+        uint32_t    last_run_us;
+        uint32_t    max_run_us;
+    };
+
+    Task tasks[MAX_TASKS];
+
+    // Returns the task index, or -1 if the table is full.
+    int AddPeriodic(const char* name, TaskFn fn, void* ctx, uint8_t priority, uint32_t period_ms);
+    int AddOneShot(const char* name, TaskFn fn, void* ctx, uint8_t priority, uint32_t delay_ms, uint32_t slack_ms);
+    void Cancel(int idx) { if (idx >= 0 && idx < MAX_TASKS) tasks[idx].active = false; }
+
+    // Runs one due task if any; returns true if something ran.
+    bool Poll();
+
+  private:
+    int Add(const char* name, TaskFn fn, void* ctx, uint8_t priority, uint32_t period_ms, uint32_t delay_ms, uint32_t slack_ms);
+};
\ No newline at end of file
@@ -31,6 +31,8 @@ static float GetNormVal(int param_id, float val) {
         case PARAM_GRAIN_SIZE: norm = (val - 0.002f) / (0.5f - 0.002f); break;
         case PARAM_GRAINS:    norm = (val - 0.5f) / (50.f - 0.5f); break;
         case PARAM_MAP_AMT:   norm = val; break; 
+        case PARAM_FILTER_CUTOFF: case PARAM_FILTER_SPREAD:
+        case PARAM_FILTER_RES: case PARAM_FILTER_TILT: norm = val; break;
         default: break;
     }
     return fclamp(norm, 0.0f, 1.0f);
@@ -43,6 +45,26 @@ static void DrawValueBar(int y, float norm) {
     if (w > 0) display.DrawRect(kBarColX, y, kBarColX + w - 1, y + bar_h - 1, true, true);
 }
 
+// --- Waveform Area (LOOPER page) ---
+const int      kWaveWidth  = 128;
+const int      kWaveTop    = 30;
+const int      kWaveBottom = 63;
+const uint32_t kMinRecView = 48000; // Keep the view from zooming in too far at rec start
+
+// One min/max column per pixel, so the cost is O(width) at any zoom
+static void DrawWaveform(const PeakMap &peaks, uint32_t start, uint32_t len) {
+    int mid = (kWaveTop + kWaveBottom) / 2;
+    int half = (kWaveBottom - kWaveTop) / 2;
+    display.DrawLine(0, mid, kWaveWidth - 1, mid, true);
+    for (int x = 0; x < kWaveWidth; x++) {
+        uint32_t a = start + (uint32_t)((uint64_t)len * x / kWaveWidth);
+        uint32_t b = start + (uint32_t)((uint64_t)len * (x + 1) / kWaveWidth);
+        float mn, mx;
+        if (!peaks.Query(a, b > a ? b : a + 1, mn, mx)) continue;
+        display.DrawLine(x, mid - (int)(mx * half), x, mid - (int)(mn * half), true);
+    }
+}
+
 void Screen::Init(DaisySeed &seed) {
     OledDisplay<OledDriver>::Config disp_cfg;
     disp_cfg.driver_config.transport_config.i2c_config.periph = I2CHandle::Config::Peripheral::I2C_1;
@@ -75,24 +97,36 @@ void Screen::DrawStatus(Processing &proc, Hardware &hw) {
             case Processing::LP_PLAY:  state_str = "PLAYING"; break;
             case Processing::LP_STOP:  state_str = "STOPPED"; break;
         }
-        display.SetCursor(10, 20);
-        display.WriteString(state_str, Font_11x18, true);
-
-        // Progress Bar (Only if not Empty)
-        if (proc.looper_state != Processing::LP_EMPTY) {
-            int bar_x = 10; int bar_y = 45; int bar_w = 108; int bar_h = 10;
-            display.DrawRect(bar_x, bar_y, bar_x + bar_w, bar_y + bar_h, true, false);
-            
-            float progress = 0.0f;
-            if (proc.looper_state == Processing::LP_REC) {
-                progress = (float)proc.rec_pos / (float)LOOPER_MAX_SAMPLES; 
-            } else if (proc.looper_state == Processing::LP_PLAY && proc.loop_len > 0) {
-                progress = (float)proc.play_pos / (float)proc.loop_len;
-            }
+        display.SetCursor(0, 14);
+        display.WriteString(state_str, Font_7x10, true);
+
+        // Pick the buffer and window to show
+        const PeakMap* peaks = proc.active_peaks;
+        uint32_t len = proc.buffer_len_samples;
+        uint32_t head = proc.write_pos;
+        if (proc.looper_state == Processing::LP_REC) {
+            peaks = proc.rec_peaks;
+            len = proc.rec_pos > kMinRecView ? proc.rec_pos : kMinRecView;
+            head = proc.rec_pos;
+        } else if (proc.looper_state != Processing::LP_EMPTY) {
+            head = proc.play_pos;
+        }
+        DrawWaveform(*peaks, 0, len);
 
-            if (progress > 1.0f) progress = 1.0f;
-            int fill_w = (int)(progress * (float)bar_w);
-            if (fill_w > 0) display.DrawRect(bar_x, bar_y, bar_x + fill_w, bar_y + bar_h, true, true);
+        if (head <= len) {
+            int x = (int)((uint64_t)head * kWaveWidth / len);
+            if (x >= kWaveWidth) x = kWaveWidth - 1;
+            display.DrawLine(x, kWaveTop, x, kWaveBottom, true);
+        }
+
+        // Active grains as ticks above the waveform
+        if (proc.looper_state != Processing::LP_REC) {
+            for (int i = 0; i < MAX_GRAINS; i++) {
+                const Processing::Grain &g = proc.grains[i];
+                if (!g.active || g.read_pos >= (float)len) continue;
+                int x = (int)(g.read_pos * (float)kWaveWidth / (float)len);
+                display.DrawLine(x, kWaveTop - 3, x, kWaveTop - 1, true);
+            }
         }
     } 
     else {
@@ -129,10 +163,34 @@ void Screen::DrawStatus(Processing &proc, Hardware &hw) {
                      display.SetCursor(kBarColX, y);
                      display.WriteString(buf, Font_6x8, true);
                 }
+                else if (item.param_id == PARAM_SCENE) {
+                     snprintf(buf, 16, "%d", (int)val);
+                     display.SetCursor(kBarColX, y);
+                     display.WriteString(buf, Font_6x8, true);
+                }
+                else if (item.param_id == PARAM_MORPH_TIME) {
+                     snprintf(buf, 16, "%.1fs", val * MAX_MORPH_SECONDS);
+                     display.SetCursor(kBarColX, y);
+                     display.WriteString(buf, Font_6x8, true);
+                }
                 else {
                     DrawValueBar(y, GetNormVal(item.param_id, val));
                 }
             }
+            else if (item.type == TYPE_ACTION && item.param_id == ACTION_SCENE_STORE) {
+                const char* status = proc.presets.Failed() ? "failed" : (proc.presets.Busy() ? "saving" : nullptr);
+                if (status) {
+                    display.SetCursor(kBarColX, y);
+                    display.WriteString(status, Font_6x8, true);
+                }
+            }
+        }
+
+        // Audio callback cost (last / worst block, in CPU cycles)
+        if (proc.advanced_mode) {
+            snprintf(buf, 32, "Cyc %lu/%lu", (unsigned long)hw.cycles_last, (unsigned long)hw.cycles_max);
+            display.SetCursor(kTextColX, 56);
+            display.WriteString(buf, Font_6x8, true);
         }
     }
     display.Update();